@@ -38,6 +38,8 @@ public:
 
     Piece getPiece(Square sq) const { return squares[sq]; }
     Color getTurn() const { return turn; }
+    uint64_t getPawnKey() const { return pawnKey; }
+    uint64_t computeHash() const; // Full Zobrist key, computed from scratch
     
     // Game state flags
     bool canCastleWK, canCastleWQ, canCastleBK, canCastleBQ;
@@ -48,8 +50,10 @@ public:
 private:
     Piece squares[64];
     Color turn;
+    uint64_t pawnKey; // Zobrist key over pawns only, kept incrementally by makeMove
 
     void clear();
+    void computePawnKey();
 };
 
 }
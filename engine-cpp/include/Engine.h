@@ -2,6 +2,7 @@
 #define ENGINE_H
 
 #include "Board.h"
+#include "PawnHash.h"
 #include <vector>
 
 namespace Chess {
@@ -17,9 +18,14 @@ class Engine {
 public:
     static AnalysisResult analyze(const Board& board, int depth);
 
+    // Pawn hash table owned by the calling thread
+    static PawnHashTable& pawnTable();
+
 private:
     static double minimax(Board& board, int depth, double alpha, double beta, bool maximizingPlayer);
     static double evaluate(const Board& board);
+    static const PawnEntry& probePawns(const Board& board);
+    static void evaluatePawns(const Board& board, PawnEntry& entry);
 };
 
 }
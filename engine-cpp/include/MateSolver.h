@@ -0,0 +1,89 @@
+#ifndef MATESOLVER_H
+#define MATESOLVER_H
+
+#include "Board.h"
+#include <stdint.h>
+#include <vector>
+
+namespace Chess {
+
+enum MateStatus {
+    MATE_PROVEN,
+    MATE_DISPROVEN,
+    MATE_UNKNOWN // Node budget ran out
+};
+
+struct MateResult {
+    MateStatus status;
+    int mateIn;             // Attacker moves to mate when proven
+    std::vector<Move> line; // Mating line (attacker and defender moves)
+    bool lineComplete;      // False if the line stops before mate (budget ran out re-proving it)
+    uint64_t nodes;         // Nodes spent proving or disproving
+    uint64_t lineNodes;     // Nodes spent re-proving evicted entries while reading the line
+};
+
+// Depth-first proof-number search (df-pn) for "side to move mates in N".
+// Attacker moves are limited to N; at the last one only checks are tried,
+// and with checksOnly every attacker move must give check.
+//
+// The table is 4-way bucketed, 32 bytes per entry. Size it at roughly 16+
+// bytes per node the proof needs: the default 16 MB holds proofs of about
+// 1M nodes (KQ vs K mate in 7 takes ~200k, mate in 9 ~815k). Much smaller
+// tables still give correct answers but re-search evicted subtrees and may
+// hit the node limit. Nodes spent re-proving entries while reading the line
+// are counted separately (lineNodes).
+class MateSolver {
+public:
+    static const size_t DEFAULT_HASH_KB = 16 * 1024;
+    static const uint64_t DEFAULT_NODE_LIMIT = 10000000;
+
+    explicit MateSolver(size_t hashKB = DEFAULT_HASH_KB);
+
+    void setNodeLimit(uint64_t limit) { nodeLimit = limit; }
+    void setChecksOnly(bool value) { checksOnly = value; }
+
+    size_t entryCount() const { return table.size(); }
+    size_t usedEntries() const;
+
+    // Finds the shortest mate in at most maxMoves attacker moves.
+    MateResult solve(const Board& board, int maxMoves);
+
+private:
+    struct Entry {
+        uint64_t key;
+        uint64_t work; // Nodes searched below this entry; cheap subtrees are evicted first
+        uint32_t pn;
+        uint32_t dn;
+        int depth;     // -1 marks an empty slot
+    };
+
+    static const size_t BUCKET_SIZE = 4;
+
+    struct Child {
+        Move move;
+        Board board;
+        uint64_t key;
+        uint32_t pn; // Kept locally so a table eviction cannot undo progress below this node
+        uint32_t dn;
+    };
+
+    std::vector<Entry> table;
+    uint64_t bucketMask;
+    uint64_t nodes;
+    uint64_t nodeLimit;
+    bool checksOnly;
+
+    size_t bucketIndex(uint64_t key, int depth) const;
+    const Entry* find(uint64_t key, int depth) const;
+    void lookup(uint64_t key, int depth, uint32_t& pn, uint32_t& dn) const;
+    void store(uint64_t key, int depth, uint32_t pn, uint32_t dn, uint64_t work);
+
+    void generateChildren(const Board& board, int depth, bool attacker, std::vector<Child>& children) const;
+    void mid(const Board& board, uint64_t key, int depth, bool attacker, uint32_t thPhi, uint32_t thDelta,
+             uint32_t& pn, uint32_t& dn);
+    bool extractLine(const Board& board, int depth, std::vector<Move>& line);
+};
+
+}
+
+#endif // MATESOLVER_H
@@ -10,6 +10,9 @@ class MoveGenerator {
 public:
     static std::vector<Move> generateLegalMoves(const Board& board);
     static bool isSquareAttacked(const Board& board, Square sq, Color attackerColor);
+    static bool isInCheck(const Board& board, Color color);
+    // after must be board with move already made on it
+    static bool isLegal(const Board& board, const Move& move, const Board& after);
 private:
     static void generatePseudoLegalMoves(const Board& board, std::vector<Move>& moves);
 };
@@ -0,0 +1,51 @@
+#ifndef PAWNHASH_H
+#define PAWNHASH_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+namespace Chess {
+
+// Cached pawn-structure terms for one pawn configuration.
+// Bitboards use bit i for Square i (A1 = bit 0).
+struct PawnEntry {
+    uint64_t key;
+    double score;        // Pawn-structure score from White's point of view
+    uint64_t pawns[2];   // Pawn occupancy per color
+    uint64_t attacks[2]; // Squares attacked by pawns per color
+    uint64_t passed[2];  // Passed pawns per color
+
+    PawnEntry() : key(0), score(0), pawns{0, 0}, attacks{0, 0}, passed{0, 0} {}
+};
+
+// Direct-mapped, always-replace table indexed by Board::getPawnKey().
+// Not thread-safe: each search thread owns its own table.
+class PawnHashTable {
+public:
+    static const size_t DEFAULT_SIZE_KB = 1024;
+
+    explicit PawnHashTable(size_t sizeKB = DEFAULT_SIZE_KB);
+
+    void resize(size_t sizeKB);
+    void clear();
+
+    // Returns the slot for key. found is true when the slot already holds
+    // key; otherwise the caller must fill the entry (including its key).
+    PawnEntry& probe(uint64_t key, bool& found);
+
+    size_t entryCount() const { return entries.size(); }
+    uint64_t getProbes() const { return probes; }
+    uint64_t getHits() const { return hits; }
+    double hitRate() const { return probes ? (double)hits / probes : 0.0; }
+
+private:
+    std::vector<PawnEntry> entries;
+    uint64_t mask;
+    uint64_t probes;
+    uint64_t hits;
+};
+
+}
+
+#endif // PAWNHASH_H
@@ -0,0 +1,139 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <string>
+
+// Search instrumentation. Build with -DCHESS_TRACE to record scopes;
+// otherwise all TRACE_* macros expand to nothing.
+//
+// TRACE_SCOPE / TRACE_SCOPE_ARG record one event per call and belong on
+// coarse units (analysis, root moves). Per-node work (move generation,
+// evaluation, makeMove) uses TRACE_COUNT, which only adds time and calls to
+// thread-local counters; TRACE_SCOPE_COUNTERS emits those totals as counter
+// events when its scope ends. Building with -DCHESS_TRACE_NODES as well
+// turns every TRACE_COUNT into a per-call event too (fills buffers fast).
+
+namespace Chess {
+
+namespace Trace {
+
+struct Event {
+    const char* name; // Must be a string literal (stored by pointer)
+    bool counter;     // Counter sample: durationNs is accumulated time, arg the call count
+    uint64_t startNs;
+    uint64_t durationNs;
+    int64_t arg;      // NO_ARG when the scope has no argument
+};
+
+const int64_t NO_ARG = INT64_MIN;
+
+enum Counter {
+    COUNTER_MOVEGEN,
+    COUNTER_EVAL,      // Includes COUNTER_PAWN_EVAL
+    COUNTER_PAWN_EVAL,
+    COUNTER_MAKEMOVE,
+    COUNTER_COUNT
+};
+
+// Default per-thread buffer capacity in events. Oldest events are overwritten.
+const uint64_t DEFAULT_BUFFER_CAPACITY = 1 << 18;
+const uint64_t MAX_BUFFER_CAPACITY = 1 << 24;
+
+// Capacity (rounded up to a power of two, at most MAX_BUFFER_CAPACITY) for
+// buffers of threads that have not recorded yet. Call before search starts.
+void setBufferCapacity(uint64_t events);
+
+// Nanoseconds since process start.
+uint64_t now();
+
+// Appends to the calling thread's ring buffer. Never blocks.
+void record(const char* name, uint64_t startNs, uint64_t endNs, int64_t arg);
+
+// Adds one call of endNs - startNs to the calling thread's counter.
+void count(Counter counter, uint64_t startNs, uint64_t endNs);
+
+// Records the calling thread's counter totals since the last flush as
+// counter events at time ns, then resets them.
+void flushCounters(uint64_t ns);
+
+// Writes every thread's buffer as Chrome/Perfetto trace-event JSON.
+// Call once search threads are idle. Returns false if tracing is compiled
+// out or the file cannot be written.
+bool writeChromeTrace(const std::string& path);
+
+class Scope {
+public:
+    explicit Scope(const char* name, int64_t arg = NO_ARG) : name(name), arg(arg), start(now()) {}
+    ~Scope() { record(name, start, now(), arg); }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* name;
+    int64_t arg;
+    uint64_t start;
+};
+
+class CounterScope {
+public:
+    CounterScope(Counter counter, const char* name) : counter(counter), name(name), start(now()) {}
+    ~CounterScope() {
+        uint64_t end = now();
+        count(counter, start, end);
+#ifdef CHESS_TRACE_NODES
+        record(name, start, end, NO_ARG);
+#endif
+    }
+
+    CounterScope(const CounterScope&) = delete;
+    CounterScope& operator=(const CounterScope&) = delete;
+
+private:
+    Counter counter;
+    const char* name;
+    uint64_t start;
+};
+
+// Scope that also flushes the counters accumulated inside it.
+class CountersScope {
+public:
+    explicit CountersScope(const char* name, int64_t arg = NO_ARG) : name(name), arg(arg), start(now()) {
+        flushCounters(start); // Attribute earlier work to whoever ran it, not to this scope
+    }
+    ~CountersScope() {
+        uint64_t end = now();
+        record(name, start, end, arg);
+        flushCounters(end);
+    }
+
+    CountersScope(const CountersScope&) = delete;
+    CountersScope& operator=(const CountersScope&) = delete;
+
+private:
+    const char* name;
+    int64_t arg;
+    uint64_t start;
+};
+
+}
+
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifdef CHESS_TRACE
+#define TRACE_SCOPE(name) ::Chess::Trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define TRACE_SCOPE_ARG(name, arg) ::Chess::Trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name, (int64_t)(arg))
+#define TRACE_SCOPE_COUNTERS(name, arg) ::Chess::Trace::CountersScope TRACE_CONCAT(traceScope_, __LINE__)(name, (int64_t)(arg))
+#define TRACE_COUNT(counter, name) ::Chess::Trace::CounterScope TRACE_CONCAT(traceScope_, __LINE__)(::Chess::Trace::counter, name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_SCOPE_ARG(name, arg) ((void)0)
+#define TRACE_SCOPE_COUNTERS(name, arg) ((void)0)
+#define TRACE_COUNT(counter, name) ((void)0)
+#endif
+
+#endif // TRACE_H
@@ -0,0 +1,25 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <stdint.h>
+#include "Constants.h"
+
+namespace Chess {
+
+namespace Zobrist {
+
+// Random key for a pawn of the given color standing on sq.
+// XOR-ing these over all pawns gives the pawn-structure key.
+uint64_t pawnKey(Color color, Square sq);
+
+// Keys for the rest of the position; see Board::computeHash().
+uint64_t pieceKey(Color color, PieceType type, Square sq);
+uint64_t sideKey();
+uint64_t castleKey(int right); // 0..3 = WK, WQ, BK, BQ
+uint64_t enPassantKey(int file);
+
+}
+
+}
+
+#endif // ZOBRIST_H
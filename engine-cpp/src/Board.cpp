@@ -1,4 +1,6 @@
 #include "Board.h"
+#include "Trace.h"
+#include "Zobrist.h"
 #include <sstream>
 #include <cctype>
 
@@ -33,9 +35,33 @@ void Board::clear() {
     enPassantSquare = SQ_NONE;
     halfMoveClock = 0;
     fullMoveNumber = 1;
+    pawnKey = 0;
+}
+
+void Board::computePawnKey() {
+    pawnKey = 0;
+    for (int i = 0; i < 64; ++i) {
+        if (squares[i].type == PAWN) pawnKey ^= Zobrist::pawnKey(squares[i].color, (Square)i);
+    }
+}
+
+uint64_t Board::computeHash() const {
+    uint64_t key = pawnKey;
+    for (int i = 0; i < 64; ++i) {
+        const Piece& p = squares[i];
+        if (p.type != EMPTY && p.type != PAWN) key ^= Zobrist::pieceKey(p.color, p.type, (Square)i);
+    }
+    if (turn == BLACK) key ^= Zobrist::sideKey();
+    if (canCastleWK) key ^= Zobrist::castleKey(0);
+    if (canCastleWQ) key ^= Zobrist::castleKey(1);
+    if (canCastleBK) key ^= Zobrist::castleKey(2);
+    if (canCastleBQ) key ^= Zobrist::castleKey(3);
+    if (enPassantSquare != SQ_NONE) key ^= Zobrist::enPassantKey(enPassantSquare % 8);
+    return key;
 }
 
 void Board::parseFEN(const std::string& fen) {
+    TRACE_SCOPE("Board::parseFEN");
     clear();
     std::stringstream ss(fen);
     std::string boardPart, turnPart, castlePart, epPart, halfPart, fullPart;
@@ -81,6 +107,8 @@ void Board::parseFEN(const std::string& fen) {
 
     if (!halfPart.empty()) halfMoveClock = std::stoi(halfPart);
     if (!fullPart.empty()) fullMoveNumber = std::stoi(fullPart);
+
+    computePawnKey();
 }
 
 std::string Board::toFEN() const {
@@ -132,11 +160,13 @@ std::string Board::toFEN() const {
 }
 
 void Board::makeMove(const Move& move) {
+    TRACE_COUNT(COUNTER_MAKEMOVE, "Board::makeMove");
     Piece p = squares[move.from];
     
     // Handle En Passant capture
     if (p.type == PAWN && move.to == enPassantSquare) {
         int capSq = (turn == WHITE) ? (move.to - 8) : (move.to + 8);
+        if (squares[capSq].type == PAWN) pawnKey ^= Zobrist::pawnKey(squares[capSq].color, (Square)capSq);
         squares[capSq] = Piece(EMPTY, NONE);
     }
 
@@ -163,11 +193,18 @@ void Board::makeMove(const Move& move) {
         }
     }
 
-    // Update Castling Rights for Rook moves
-    if (move.from == A1) canCastleWQ = false;
-    if (move.from == H1) canCastleWK = false;
-    if (move.from == A8) canCastleBQ = false;
-    if (move.from == H8) canCastleBK = false;
+    // Update Castling Rights for Rook moves and captures
+    if (move.from == A1 || move.to == A1) canCastleWQ = false;
+    if (move.from == H1 || move.to == H1) canCastleWK = false;
+    if (move.from == A8 || move.to == A8) canCastleBQ = false;
+    if (move.from == H8 || move.to == H8) canCastleBK = false;
+
+    // Update pawn key: captured pawn leaves, moving pawn leaves its square (and lands unless promoting)
+    if (squares[move.to].type == PAWN) pawnKey ^= Zobrist::pawnKey(squares[move.to].color, move.to);
+    if (p.type == PAWN) {
+        pawnKey ^= Zobrist::pawnKey(p.color, move.from);
+        if (move.promotion == EMPTY) pawnKey ^= Zobrist::pawnKey(p.color, move.to);
+    }
 
     // Move piece
     squares[move.to] = p;
@@ -1,5 +1,6 @@
 #include "Engine.h"
 #include "MoveGenerator.h"
+#include "Trace.h"
 #include <algorithm>
 #include <limits>
 
@@ -7,7 +8,24 @@ namespace Chess {
 
 const double INF = std::numeric_limits<double>::infinity();
 
+// Pawn-structure weights (in pawns)
+const double DOUBLED_PAWN_PENALTY = 0.15;
+const double ISOLATED_PAWN_PENALTY = 0.15;
+const double PASSED_PAWN_BONUS[8] = {0, 0.05, 0.1, 0.2, 0.35, 0.6, 1.0, 0}; // Indexed by relative rank
+const double PAWN_SHIELD_BONUS[2] = {0.1, 0.05}; // Shield pawn one / two ranks in front of king
+const double PAWN_ATTACKED_PIECE_PENALTY = 0.2;
+
+uint64_t fileMask(int c) {
+    return 0x0101010101010101ULL << c;
+}
+
+PawnHashTable& Engine::pawnTable() {
+    thread_local PawnHashTable table;
+    return table;
+}
+
 AnalysisResult Engine::analyze(const Board& board, int depth) {
+    TRACE_SCOPE_ARG("Engine::analyze", depth);
     auto moves = MoveGenerator::generateLegalMoves(board);
     AnalysisResult result;
     result.depth = depth;
@@ -16,7 +34,9 @@ AnalysisResult Engine::analyze(const Board& board, int depth) {
 
     std::vector<std::pair<Move, double>> scoredMoves;
 
-    for (const auto& move : moves) {
+    for (size_t i = 0; i < moves.size(); ++i) {
+        const Move& move = moves[i];
+        TRACE_SCOPE_COUNTERS("root move", i);
         Board nextBoard = board;
         nextBoard.makeMove(move);
         double score = minimax(nextBoard, depth - 1, -INF, INF, board.getTurn() == BLACK);
@@ -84,7 +104,10 @@ double Engine::minimax(Board& board, int depth, double alpha, double beta, bool
 }
 
 double Engine::evaluate(const Board& board) {
-    double score = 0;
+    TRACE_COUNT(COUNTER_EVAL, "Engine::evaluate");
+    const PawnEntry& pawns = probePawns(board);
+    double score = pawns.score;
+
     for (int i = 0; i < 64; ++i) {
         Piece p = board.getPiece((Square)i);
         double val = 0;
@@ -102,6 +125,27 @@ double Engine::evaluate(const Board& board) {
         int r = i / 8, c = i % 8;
         double activity = 0;
         if (r >= 2 && r <= 5 && c >= 2 && c <= 5) activity = 0.1;
+
+        if (p.type != EMPTY && p.type != PAWN && p.type != KING) {
+            // Piece standing where an enemy pawn can take it
+            Color them = (p.color == WHITE) ? BLACK : WHITE;
+            if (pawns.attacks[them] & (1ULL << i)) activity -= PAWN_ATTACKED_PIECE_PENALTY;
+        } else if (p.type == KING) {
+            // Pawn shield on the king's file and its neighbours
+            int dir = (p.color == WHITE) ? 1 : -1;
+            for (int dc = -1; dc <= 1; ++dc) {
+                int nc = c + dc;
+                if (nc < 0 || nc > 7) continue;
+                for (int step = 1; step <= 2; ++step) {
+                    int nr = r + dir * step;
+                    if (nr < 0 || nr > 7) break;
+                    if (pawns.pawns[p.color] & (1ULL << (nr * 8 + nc))) {
+                        activity += PAWN_SHIELD_BONUS[step - 1];
+                        break;
+                    }
+                }
+            }
+        }
         
         if (p.color == WHITE) score += (val + activity);
         else if (p.color == BLACK) score -= (val + activity);
@@ -109,4 +153,64 @@ double Engine::evaluate(const Board& board) {
     return score;
 }
 
+const PawnEntry& Engine::probePawns(const Board& board) {
+    bool found;
+    PawnEntry& entry = pawnTable().probe(board.getPawnKey(), found);
+    if (!found) evaluatePawns(board, entry);
+    return entry;
+}
+
+void Engine::evaluatePawns(const Board& board, PawnEntry& entry) {
+    TRACE_COUNT(COUNTER_PAWN_EVAL, "Engine::evaluatePawns");
+    entry = PawnEntry();
+    entry.key = board.getPawnKey();
+
+    for (int i = 0; i < 64; ++i) {
+        Piece p = board.getPiece((Square)i);
+        if (p.type != PAWN) continue;
+        int r = i / 8, c = i % 8;
+        int dir = (p.color == WHITE) ? 1 : -1;
+        entry.pawns[p.color] |= 1ULL << i;
+        int ar = r + dir;
+        if (ar >= 0 && ar <= 7) {
+            if (c > 0) entry.attacks[p.color] |= 1ULL << (ar * 8 + c - 1);
+            if (c < 7) entry.attacks[p.color] |= 1ULL << (ar * 8 + c + 1);
+        }
+    }
+
+    for (int color = WHITE; color <= BLACK; ++color) {
+        uint64_t ours = entry.pawns[color];
+        uint64_t theirs = entry.pawns[color == WHITE ? BLACK : WHITE];
+        double sideScore = 0;
+
+        for (int c = 0; c < 8; ++c) {
+            int count = __builtin_popcountll(ours & fileMask(c));
+            if (count == 0) continue;
+            if (count > 1) sideScore -= DOUBLED_PAWN_PENALTY * (count - 1);
+
+            uint64_t adjacent = (c > 0 ? fileMask(c - 1) : 0) | (c < 7 ? fileMask(c + 1) : 0);
+            if (!(ours & adjacent)) sideScore -= ISOLATED_PAWN_PENALTY * count;
+        }
+
+        for (int i = 0; i < 64; ++i) {
+            if (!(ours & (1ULL << i))) continue;
+            int r = i / 8, c = i % 8;
+
+            // Passed: no enemy pawn ahead on this or an adjacent file
+            uint64_t front = 0;
+            for (int nr = r + (color == WHITE ? 1 : -1); nr >= 0 && nr <= 7; nr += (color == WHITE ? 1 : -1)) {
+                for (int nc = c - 1; nc <= c + 1; ++nc) {
+                    if (nc >= 0 && nc <= 7) front |= 1ULL << (nr * 8 + nc);
+                }
+            }
+            if (!(theirs & front)) {
+                entry.passed[color] |= 1ULL << i;
+                sideScore += PASSED_PAWN_BONUS[color == WHITE ? r : 7 - r];
+            }
+        }
+
+        entry.score += (color == WHITE) ? sideScore : -sideScore;
+    }
+}
+
 }
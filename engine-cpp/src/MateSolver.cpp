@@ -0,0 +1,264 @@
+#include "MateSolver.h"
+#include "MoveGenerator.h"
+#include "Trace.h"
+#include <algorithm>
+
+namespace Chess {
+
+// Proof / disproof numbers saturate at PN_INF (proven or disproven)
+const uint32_t PN_INF = 100000000;
+
+uint32_t addSaturated(uint32_t a, uint32_t b) {
+    return std::min(a + b, PN_INF);
+}
+
+bool isSolved(uint32_t pn, uint32_t dn) {
+    return pn == 0 || dn == 0;
+}
+
+MateSolver::MateSolver(size_t hashKB) : nodes(0), nodeLimit(DEFAULT_NODE_LIMIT), checksOnly(false) {
+    // Power-of-two bucket count so the index is a simple mask
+    size_t buckets = 1;
+    size_t wanted = (hashKB * 1024) / (sizeof(Entry) * BUCKET_SIZE);
+    while (buckets * 2 <= wanted) buckets *= 2;
+    table.assign(buckets * BUCKET_SIZE, Entry{0, 0, 1, 1, -1});
+    bucketMask = buckets - 1;
+}
+
+size_t MateSolver::usedEntries() const {
+    size_t used = 0;
+    for (const auto& e : table) {
+        if (e.depth >= 0) used++;
+    }
+    return used;
+}
+
+size_t MateSolver::bucketIndex(uint64_t key, int depth) const {
+    return ((key ^ (uint64_t)depth * 0x9E3779B97F4A7C15ULL) & bucketMask) * BUCKET_SIZE;
+}
+
+const MateSolver::Entry* MateSolver::find(uint64_t key, int depth) const {
+    const Entry* slots = &table[bucketIndex(key, depth)];
+    for (size_t i = 0; i < BUCKET_SIZE; ++i) {
+        if (slots[i].key == key && slots[i].depth == depth) return &slots[i];
+    }
+    return nullptr;
+}
+
+void MateSolver::lookup(uint64_t key, int depth, uint32_t& pn, uint32_t& dn) const {
+    const Entry* e = find(key, depth);
+    if (e) {
+        pn = e->pn;
+        dn = e->dn;
+    } else {
+        pn = dn = 1;
+    }
+}
+
+void MateSolver::store(uint64_t key, int depth, uint32_t pn, uint32_t dn, uint64_t work) {
+    // An evicted proof or disproof comes back as (1, 1) and has to be searched
+    // again, so a solved entry is never displaced by an unsolved one. Otherwise
+    // the victim is an empty slot, then the unsolved entry with the least work,
+    // then the solved entry with the least work.
+    Entry* slots = &table[bucketIndex(key, depth)];
+    bool solved = isSolved(pn, dn);
+    Entry* victim = nullptr;
+    for (size_t i = 0; i < BUCKET_SIZE; ++i) {
+        Entry& e = slots[i];
+        if (e.key == key && e.depth == depth) {
+            if (isSolved(e.pn, e.dn) && !solved) return;
+            victim = &e;
+            break;
+        }
+        if (e.depth < 0) {
+            victim = &e;
+            break;
+        }
+        bool eSolved = isSolved(e.pn, e.dn);
+        if (eSolved && !solved) continue;
+        if (!victim) {
+            victim = &e;
+            continue;
+        }
+        bool victimSolved = isSolved(victim->pn, victim->dn);
+        if (eSolved != victimSolved ? !eSolved : e.work < victim->work) victim = &e;
+    }
+    if (!victim) return; // Bucket holds only solved entries: drop this unsolved one
+
+    victim->key = key;
+    victim->depth = depth;
+    victim->pn = pn;
+    victim->dn = dn;
+    victim->work = work;
+}
+
+void MateSolver::generateChildren(const Board& board, int depth, bool attacker, std::vector<Child>& children) const {
+    Color them = (board.getTurn() == WHITE) ? BLACK : WHITE;
+    // A mating move is always a check, so the last attacker move only needs checks
+    bool onlyChecks = attacker && (checksOnly || depth == 1);
+    // Checks first so ties in proof numbers favour forcing moves
+    std::vector<Child> quiet;
+
+    for (const auto& move : MoveGenerator::generateLegalMoves(board)) {
+        Child child;
+        child.move = move;
+        child.board = board;
+        child.board.makeMove(move);
+        if (!MoveGenerator::isLegal(board, move, child.board)) continue;
+
+        bool givesCheck = MoveGenerator::isInCheck(child.board, them);
+        if (onlyChecks && !givesCheck) continue;
+
+        child.key = child.board.computeHash();
+        lookup(child.key, attacker ? depth - 1 : depth, child.pn, child.dn);
+        if (givesCheck) children.push_back(child);
+        else quiet.push_back(child);
+
+        // Defender out of attacker moves: one legal reply already refutes the mate
+        if (!attacker && depth == 0) break;
+    }
+    children.insert(children.end(), quiet.begin(), quiet.end());
+}
+
+void MateSolver::mid(const Board& board, uint64_t key, int depth, bool attacker, uint32_t thPhi, uint32_t thDelta,
+                     uint32_t& pn, uint32_t& dn) {
+    const Entry* existing = find(key, depth);
+    if (existing) {
+        pn = existing->pn;
+        dn = existing->dn;
+        uint32_t phi = attacker ? pn : dn;
+        uint32_t delta = attacker ? dn : pn;
+        if (isSolved(phi, delta) || phi >= thPhi || delta >= thDelta) return;
+    }
+    uint64_t startNodes = nodes - (existing ? existing->work : 0);
+    nodes++;
+
+    // phi/delta are the proof/disproof numbers from the side to move's point of view:
+    // phi = pn, delta = dn at attacker nodes, and the reverse at defender nodes
+    std::vector<Child> children;
+    generateChildren(board, depth, attacker, children);
+
+    if (children.empty()) {
+        // Attacker without (useful) moves fails; defender without moves is mated or stalemated
+        bool mated = !attacker && MoveGenerator::isInCheck(board, board.getTurn());
+        pn = mated ? 0 : PN_INF;
+        dn = mated ? PN_INF : 0;
+        store(key, depth, pn, dn, nodes - startNodes);
+        return;
+    }
+    if (!attacker && depth == 0) {
+        pn = PN_INF;
+        dn = 0;
+        store(key, depth, pn, dn, nodes - startNodes);
+        return;
+    }
+
+    int childDepth = attacker ? depth - 1 : depth;
+
+    while (true) {
+        uint32_t phi = PN_INF, delta = 0, secondPhi = PN_INF, bestDelta = 0;
+        size_t best = 0;
+        for (size_t i = 0; i < children.size(); ++i) {
+            // Child's phi/delta: the child has the other side to move
+            uint32_t childPhi = attacker ? children[i].dn : children[i].pn;
+            uint32_t childDelta = attacker ? children[i].pn : children[i].dn;
+            delta = addSaturated(delta, childPhi);
+            if (childDelta < phi) {
+                secondPhi = phi;
+                phi = childDelta;
+                best = i;
+                bestDelta = childPhi;
+            } else if (childDelta < secondPhi) {
+                secondPhi = childDelta;
+            }
+        }
+
+        pn = attacker ? phi : delta;
+        dn = attacker ? delta : phi;
+        store(key, depth, pn, dn, nodes - startNodes);
+        if (phi >= thPhi || delta >= thDelta || nodes >= nodeLimit) return;
+
+        uint32_t childThPhi = thDelta + bestDelta - delta;
+        uint32_t childThDelta = std::min(thPhi, addSaturated(secondPhi, 1));
+        Child& child = children[best];
+        mid(child.board, child.key, childDepth, !attacker, childThPhi, childThDelta, child.pn, child.dn);
+    }
+}
+
+MateResult MateSolver::solve(const Board& board, int maxMoves) {
+    TRACE_SCOPE_ARG("MateSolver::solve", maxMoves);
+    MateResult result;
+    result.status = MATE_DISPROVEN;
+    result.mateIn = 0;
+    result.lineComplete = true;
+    result.lineNodes = 0;
+    nodes = 0;
+
+    uint64_t key = board.computeHash();
+    // Iterate on the mate length so the first proof is the shortest mate
+    for (int n = 1; n <= maxMoves; ++n) {
+        TRACE_SCOPE_ARG("mate iteration", n);
+        uint32_t pn = 1, dn = 1;
+        mid(board, key, n, true, PN_INF, PN_INF, pn, dn);
+        if (pn == 0) {
+            result.status = MATE_PROVEN;
+            result.mateIn = n;
+            result.nodes = nodes;
+            // Line extraction gets its own node count and budget
+            nodes = 0;
+            result.lineComplete = extractLine(board, n, result.line);
+            result.lineNodes = nodes;
+            return result;
+        }
+        if (dn != 0) {
+            result.status = MATE_UNKNOWN;
+            break;
+        }
+    }
+
+    result.nodes = nodes;
+    return result;
+}
+
+bool MateSolver::extractLine(const Board& board, int depth, std::vector<Move>& line) {
+    Board current = board;
+    bool attacker = true;
+
+    while (true) {
+        std::vector<Child> children;
+        generateChildren(current, depth, attacker, children);
+        if (children.empty()) return !attacker; // Defender is mated
+
+        int childDepth = attacker ? depth - 1 : depth;
+        Child* next = nullptr;
+        for (auto& child : children) {
+            if (child.pn != 0) continue;
+            if (!next) next = &child;
+            if (attacker) break;
+
+            // Defender: prefer a reply already known to survive one attacker move fewer
+            uint32_t shorterPn, shorterDn;
+            lookup(child.key, childDepth - 1, shorterPn, shorterDn);
+            if (shorterDn == 0) {
+                next = &child;
+                break;
+            }
+        }
+
+        // No proven child left in the table: re-prove evicted ones until one holds
+        for (auto& child : children) {
+            if (next) break;
+            if (child.pn == 0 || child.dn == 0) continue;
+            mid(child.board, child.key, childDepth, !attacker, PN_INF, PN_INF, child.pn, child.dn);
+            if (child.pn == 0) next = &child;
+        }
+        if (!next) return false; // Node budget ran out while re-proving
+
+        line.push_back(next->move);
+        current = next->board;
+        depth = childDepth;
+        attacker = !attacker;
+    }
+}
+
+}
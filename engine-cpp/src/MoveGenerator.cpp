@@ -1,5 +1,7 @@
 #include "MoveGenerator.h"
+#include "Trace.h"
 #include <algorithm>
+#include <cstdlib>
 
 namespace Chess {
 
@@ -204,6 +206,28 @@ bool MoveGenerator::isSquareAttacked(const Board& board, Square sq, Color attack
     return false;
 }
 
+bool MoveGenerator::isInCheck(const Board& board, Color color) {
+    for (int i = 0; i < 64; ++i) {
+        Piece p = board.getPiece((Square)i);
+        if (p.type == KING && p.color == color) {
+            return isSquareAttacked(board, (Square)i, (color == WHITE) ? BLACK : WHITE);
+        }
+    }
+    return false;
+}
+
+bool MoveGenerator::isLegal(const Board& board, const Move& move, const Board& after) {
+    Color us = board.getTurn();
+    Color them = (us == WHITE) ? BLACK : WHITE;
+
+    // Castling may not start from or pass through an attacked square
+    if (board.getPiece(move.from).type == KING && std::abs((int)move.to - (int)move.from) == 2) {
+        Square passed = (Square)((move.from + move.to) / 2);
+        if (isSquareAttacked(board, move.from, them) || isSquareAttacked(board, passed, them)) return false;
+    }
+    return !isInCheck(after, us);
+}
+
 // Dummy board update for move legality check
 Board makeMove(Board board, Move move) {
     Piece p = board.getPiece(move.from);
@@ -219,6 +243,7 @@ Board makeMove(Board board, Move move) {
 // I'll implement a basic makeMove in Board if needed, but let's see.
 
 std::vector<Move> MoveGenerator::generateLegalMoves(const Board& board) {
+    TRACE_COUNT(COUNTER_MOVEGEN, "MoveGenerator::generateLegalMoves");
     std::vector<Move> pseudo;
     generatePseudoLegalMoves(board, pseudo);
     // TODO: Filter only legal moves (king not in check after move)
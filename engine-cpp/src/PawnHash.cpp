@@ -0,0 +1,34 @@
+#include "PawnHash.h"
+
+namespace Chess {
+
+PawnHashTable::PawnHashTable(size_t sizeKB) {
+    resize(sizeKB);
+}
+
+void PawnHashTable::resize(size_t sizeKB) {
+    // Round down to a power of two so the index is a simple mask
+    size_t count = 1;
+    size_t wanted = (sizeKB * 1024) / sizeof(PawnEntry);
+    while (count * 2 <= wanted) count *= 2;
+
+    entries.assign(count, PawnEntry());
+    mask = count - 1;
+    probes = hits = 0;
+}
+
+void PawnHashTable::clear() {
+    entries.assign(entries.size(), PawnEntry());
+    probes = hits = 0;
+}
+
+PawnEntry& PawnHashTable::probe(uint64_t key, bool& found) {
+    PawnEntry& entry = entries[key & mask];
+    probes++;
+    // A key of 0 only occurs with no pawns at all; the empty slot then holds the right (zero) terms.
+    found = (entry.key == key);
+    if (found) hits++;
+    return entry;
+}
+
+}
@@ -0,0 +1,160 @@
+#include "Trace.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+namespace Chess {
+
+namespace Trace {
+
+namespace {
+
+const std::chrono::steady_clock::time_point processStart = std::chrono::steady_clock::now();
+
+// Single-writer ring buffer. Only the owning thread writes; the exporter
+// reads after search has finished, using head to know what is valid.
+struct ThreadBuffer {
+    std::vector<Event> events;
+    uint64_t mask;
+    std::atomic<uint64_t> head;
+    int threadId;
+    ThreadBuffer* next;
+    uint64_t counterCalls[COUNTER_COUNT];
+    uint64_t counterNs[COUNTER_COUNT];
+
+    explicit ThreadBuffer(uint64_t capacity)
+        : events(capacity), mask(capacity - 1), head(0), threadId(0), next(nullptr), counterCalls(), counterNs() {}
+};
+
+const char* const COUNTER_NAMES[COUNTER_COUNT] = {"movegen", "eval", "pawn eval", "makeMove"};
+
+// Lock-free registry of all thread buffers (push-only list). Buffers are
+// never freed so a trace can still be written after its thread exits.
+std::atomic<ThreadBuffer*> registry(nullptr);
+std::atomic<int> nextThreadId(0);
+std::atomic<uint64_t> bufferCapacity(DEFAULT_BUFFER_CAPACITY);
+
+ThreadBuffer* registerThread() {
+    ThreadBuffer* buffer = new ThreadBuffer(bufferCapacity.load(std::memory_order_relaxed));
+    buffer->threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    ThreadBuffer* old = registry.load(std::memory_order_relaxed);
+    do {
+        buffer->next = old;
+    } while (!registry.compare_exchange_weak(old, buffer, std::memory_order_release, std::memory_order_relaxed));
+    return buffer;
+}
+
+ThreadBuffer& localBuffer() {
+    thread_local ThreadBuffer* buffer = registerThread();
+    return *buffer;
+}
+
+void append(ThreadBuffer& buffer, const char* name, bool counter, uint64_t startNs, uint64_t durationNs, int64_t arg) {
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    Event& e = buffer.events[head & buffer.mask];
+    e.name = name;
+    e.counter = counter;
+    e.startNs = startNs;
+    e.durationNs = durationNs;
+    e.arg = arg;
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+#ifdef CHESS_TRACE
+void writeEscaped(std::ofstream& out, const char* s) {
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') out << '\\';
+        out << *s;
+    }
+}
+
+// Chrome expects microseconds; keep nanosecond precision as decimals
+void writeMicros(std::ofstream& out, uint64_t ns) {
+    out << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000 << std::setfill(' ');
+}
+#endif
+
+}
+
+void setBufferCapacity(uint64_t events) {
+    uint64_t capacity = 1;
+    while (capacity < events && capacity < MAX_BUFFER_CAPACITY) capacity *= 2;
+    bufferCapacity.store(capacity, std::memory_order_relaxed);
+}
+
+uint64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - processStart).count();
+}
+
+void record(const char* name, uint64_t startNs, uint64_t endNs, int64_t arg) {
+    append(localBuffer(), name, false, startNs, endNs - startNs, arg);
+}
+
+void count(Counter counter, uint64_t startNs, uint64_t endNs) {
+    ThreadBuffer& buffer = localBuffer();
+    buffer.counterCalls[counter]++;
+    buffer.counterNs[counter] += endNs - startNs;
+}
+
+void flushCounters(uint64_t ns) {
+    ThreadBuffer& buffer = localBuffer();
+    for (int c = 0; c < COUNTER_COUNT; ++c) {
+        append(buffer, COUNTER_NAMES[c], true, ns, buffer.counterNs[c], (int64_t)buffer.counterCalls[c]);
+        buffer.counterCalls[c] = buffer.counterNs[c] = 0;
+    }
+}
+
+bool writeChromeTrace(const std::string& path) {
+#ifndef CHESS_TRACE
+    (void)path;
+    return false;
+#else
+    std::ofstream out(path);
+    if (!out) return false;
+
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [" << std::endl;
+    bool first = true;
+    for (ThreadBuffer* buffer = registry.load(std::memory_order_acquire); buffer; buffer = buffer->next) {
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t capacity = buffer->events.size();
+        uint64_t begin = (head > capacity) ? head - capacity : 0;
+
+        if (!first) out << "," << std::endl;
+        first = false;
+        out << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->threadId
+            << ", \"args\": {\"name\": \"thread-" << buffer->threadId << "\"}}";
+        if (begin > 0) {
+            out << "," << std::endl << "{\"name\": \"dropped_events\", \"ph\": \"i\", \"s\": \"t\", \"pid\": 1, \"tid\": "
+                << buffer->threadId << ", \"ts\": 0, \"args\": {\"count\": " << begin << "}}";
+        }
+
+        for (uint64_t i = begin; i < head; ++i) {
+            const Event& e = buffer->events[i & buffer->mask];
+            out << "," << std::endl << "{\"name\": \"";
+            writeEscaped(out, e.name);
+            out << "\", \"ph\": \"" << (e.counter ? 'C' : 'X') << "\", \"pid\": 1, \"tid\": " << buffer->threadId
+                << ", \"ts\": ";
+            writeMicros(out, e.startNs);
+            if (e.counter) {
+                // Per-interval totals since the previous sample
+                out << ", \"args\": {\"calls\": " << e.arg << ", \"us\": ";
+                writeMicros(out, e.durationNs);
+                out << "}}";
+                continue;
+            }
+            out << ", \"dur\": ";
+            writeMicros(out, e.durationNs);
+            if (e.arg != NO_ARG) out << ", \"args\": {\"value\": " << e.arg << "}";
+            out << "}";
+        }
+    }
+    out << std::endl << "]}" << std::endl;
+    return (bool)out;
+#endif
+}
+
+}
+
+}
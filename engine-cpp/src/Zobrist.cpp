@@ -0,0 +1,63 @@
+#include "Zobrist.h"
+
+namespace Chess {
+
+namespace Zobrist {
+
+namespace {
+
+struct Keys {
+    uint64_t pieces[2][7][64];
+    uint64_t side;
+    uint64_t castle[4];
+    uint64_t enPassant[8];
+
+    Keys() {
+        // Fixed seed so keys (and hash table behaviour) are reproducible between runs
+        uint64_t state = 0x9E3779B97F4A7C15ULL;
+        for (int c = 0; c < 2; ++c) {
+            for (int t = 0; t < 7; ++t) {
+                for (int sq = 0; sq < 64; ++sq) pieces[c][t][sq] = next(state);
+            }
+        }
+        side = next(state);
+        for (int i = 0; i < 4; ++i) castle[i] = next(state);
+        for (int i = 0; i < 8; ++i) enPassant[i] = next(state);
+    }
+
+    // xorshift64*
+    static uint64_t next(uint64_t& state) {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1DULL;
+    }
+};
+
+const Keys keys;
+
+}
+
+uint64_t pawnKey(Color color, Square sq) {
+    return keys.pieces[color][PAWN][sq];
+}
+
+uint64_t pieceKey(Color color, PieceType type, Square sq) {
+    return keys.pieces[color][type][sq];
+}
+
+uint64_t sideKey() {
+    return keys.side;
+}
+
+uint64_t castleKey(int right) {
+    return keys.castle[right];
+}
+
+uint64_t enPassantKey(int file) {
+    return keys.enPassant[file];
+}
+
+}
+
+}
@@ -3,12 +3,21 @@
 #include <vector>
 #include "Board.h"
 #include "Engine.h"
+#include "MateSolver.h"
+#include "Trace.h"
 
 using namespace Chess;
 
 int main(int argc, char* argv[]) {
     std::string fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
     int depth = 4;
+    bool showStats = false;
+    std::string tracePath;
+    bool mateMode = false;
+    int mateMoves = 0;
+    size_t mateHashKB = MateSolver::DEFAULT_HASH_KB;
+    uint64_t mateNodes = MateSolver::DEFAULT_NODE_LIMIT;
+    bool checksOnly = false;
 
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -16,27 +25,103 @@ int main(int argc, char* argv[]) {
             fen = argv[++i];
         } else if (arg == "--depth" && i + 1 < argc) {
             depth = std::stoi(argv[++i]);
+        } else if (arg == "--pawn-hash" && i + 1 < argc) {
+            Engine::pawnTable().resize(std::stoul(argv[++i]));
+        } else if (arg == "--trace" && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (arg == "--trace-buffer" && i + 1 < argc) {
+            long long events = std::stoll(argv[++i]);
+            if (events < 1) {
+                std::cerr << "--trace-buffer expects a number of events >= 1" << std::endl;
+                return 1;
+            }
+            Trace::setBufferCapacity((uint64_t)events);
+        } else if (arg == "--mate" && i + 1 < argc) {
+            mateMode = true;
+            mateMoves = std::stoi(argv[++i]);
+        } else if (arg == "--mate-hash" && i + 1 < argc) {
+            mateHashKB = std::stoul(argv[++i]);
+        } else if (arg == "--mate-nodes" && i + 1 < argc) {
+            mateNodes = std::stoull(argv[++i]);
+        } else if (arg == "--checks-only") {
+            checksOnly = true;
+        } else if (arg == "--stats") {
+            showStats = true;
         }
     }
 
+    if (mateMode && mateMoves < 1) {
+        std::cerr << "--mate expects a number of moves >= 1" << std::endl;
+        return 1;
+    }
+
     Board board;
     board.parseFEN(fen);
 
-    AnalysisResult result = Engine::analyze(board, depth);
-
-    // Manual JSON Output
-    std::cout << "{" << std::endl;
-    std::cout << "  \"bestMove\": \"" << result.bestMove.toString() << "\"," << std::endl;
-    std::cout << "  \"evaluation\": " << result.evaluation << "," << std::endl;
-    std::cout << "  \"depth\": " << result.depth << "," << std::endl;
-    std::cout << "  \"topMoves\": [" << std::endl;
-    for (size_t i = 0; i < result.topMoves.size(); ++i) {
-        std::cout << "    {\"move\": \"" << result.topMoves[i].first.toString() << "\", \"score\": " << result.topMoves[i].second << "}";
-        if (i < result.topMoves.size() - 1) std::cout << ",";
+    if (mateMode) {
+        MateSolver solver(mateHashKB);
+        solver.setNodeLimit(mateNodes);
+        solver.setChecksOnly(checksOnly);
+        MateResult result = solver.solve(board, mateMoves);
+
+        const char* status = (result.status == MATE_PROVEN) ? "proven"
+                           : (result.status == MATE_DISPROVEN) ? "disproven" : "unknown";
+        std::cout << "{" << std::endl;
+        std::cout << "  \"mode\": \"mate\"," << std::endl;
+        std::cout << "  \"status\": \"" << status << "\"," << std::endl;
+        std::cout << "  \"mateIn\": " << result.mateIn << "," << std::endl;
+        std::cout << "  \"bestMove\": \"" << (result.line.empty() ? Move() : result.line[0]).toString() << "\"," << std::endl;
+        std::cout << "  \"line\": [";
+        for (size_t i = 0; i < result.line.size(); ++i) {
+            std::cout << "\"" << result.line[i].toString() << "\"";
+            if (i < result.line.size() - 1) std::cout << ", ";
+        }
+        std::cout << "]," << std::endl;
+        std::cout << "  \"lineComplete\": " << (result.lineComplete ? "true" : "false") << "," << std::endl;
+        std::cout << "  \"nodes\": " << result.nodes << "," << std::endl;
+        std::cout << "  \"lineNodes\": " << result.lineNodes;
+        if (showStats) {
+            std::cout << "," << std::endl;
+            std::cout << "  \"mateHash\": {\"entries\": " << solver.entryCount()
+                      << ", \"used\": " << solver.usedEntries()
+                      << ", \"fill\": " << (double)solver.usedEntries() / solver.entryCount() << "}";
+        }
         std::cout << std::endl;
+        std::cout << "}" << std::endl;
+    } else {
+        AnalysisResult result = Engine::analyze(board, depth);
+
+        // Manual JSON Output
+        std::cout << "{" << std::endl;
+        std::cout << "  \"bestMove\": \"" << result.bestMove.toString() << "\"," << std::endl;
+        std::cout << "  \"evaluation\": " << result.evaluation << "," << std::endl;
+        std::cout << "  \"depth\": " << result.depth << "," << std::endl;
+        std::cout << "  \"topMoves\": [" << std::endl;
+        for (size_t i = 0; i < result.topMoves.size(); ++i) {
+            std::cout << "    {\"move\": \"" << result.topMoves[i].first.toString() << "\", \"score\": " << result.topMoves[i].second << "}";
+            if (i < result.topMoves.size() - 1) std::cout << ",";
+            std::cout << std::endl;
+        }
+        std::cout << "  ]";
+        if (showStats) {
+            const PawnHashTable& pawns = Engine::pawnTable();
+            std::cout << "," << std::endl;
+            std::cout << "  \"pawnHash\": {\"entries\": " << pawns.entryCount()
+                      << ", \"probes\": " << pawns.getProbes()
+                      << ", \"hits\": " << pawns.getHits()
+                      << ", \"hitRate\": " << pawns.hitRate() << "}";
+        }
+        std::cout << std::endl;
+        std::cout << "}" << std::endl;
+    }
+
+    if (!tracePath.empty() && !Trace::writeChromeTrace(tracePath)) {
+#ifdef CHESS_TRACE
+        std::cerr << "Failed to write trace file: " << tracePath << std::endl;
+#else
+        std::cerr << "Tracing not compiled in; rebuild with -DCHESS_TRACE to use --trace" << std::endl;
+#endif
     }
-    std::cout << "  ]" << std::endl;
-    std::cout << "}" << std::endl;
 
     return 0;
 }